@@ -0,0 +1,670 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Throughput and latency of serial_gateway, measured locally.
+// The "device" is the controller side of a pseudo-terminal pair
+// whose follower side is opened as a serial_posix port. The remote
+// tool is a loopback TCP connection. The transferred data are
+// verified in both directions in every run.
+//
+//   splice    one link, moved with splice(2)
+//   buffered  one link, moved with pooled buffers
+//   fallback  one link, splice requested, but the follower is opened
+//             with O_APPEND, which the kernel refuses to splice into.
+//             Data already spliced from the socket into the pipe must
+//             then be carried over into a pooled buffer.
+//   multi     several links served concurrently by one gateway
+//
+// These are preceded by short pass/fail checks of the link life cycle:
+// a duplicate add(), a half-close with allow_half_close, a reconnect
+// after the client has closed, remove(), and a too-small chunk size.
+//
+// Any wait that makes no progress for a while counts as a failure,
+// so a stalled gateway fails the run instead of hanging it.
+//
+//   g++ -std=c++14 -O2 -Wall -Wextra -I. -Iserial bench_serial_gateway.cpp -pthread -o bench_serial_gateway
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <serial_gateway.h>
+
+namespace local
+{
+  using clock_type = std::chrono::steady_clock;
+
+  constexpr auto throughput_bytes = static_cast<std::size_t>(UINT32_C(0x1000000));
+  constexpr auto multi_bytes      = static_cast<std::size_t>(UINT32_C(0x400000));
+  constexpr auto multi_links      = static_cast<std::size_t>(UINT8_C(8));
+  constexpr auto latency_rounds   = static_cast<std::size_t>(UINT16_C(2000));
+  constexpr auto stall_timeout_ms = static_cast<int>(INT16_C(10000));
+
+  auto pattern_byte(const std::size_t i) -> std::uint8_t
+  {
+    return static_cast<std::uint8_t>(i % static_cast<std::size_t>(UINT8_C(251)));
+  }
+
+  auto close_fd(int& fd) -> void
+  {
+    if(fd >= 0)
+    {
+      static_cast<void>(::close(fd));
+    }
+
+    fd = -1;
+  }
+
+  auto set_nonblocking(const int fd) -> bool
+  {
+    const auto fd_flags = ::fcntl(fd, F_GETFL);
+
+    return ((fd_flags >= 0) && (::fcntl(fd, F_SETFL, fd_flags | O_NONBLOCK) == 0));
+  }
+
+  // Wait until fd is ready for the given events. Returns false if
+  // nothing happened within the stall timeout.
+  auto wait_for(const int fd, const short events) -> bool
+  {
+    auto pfd = ::pollfd { fd, events, static_cast<short>(0) };
+
+    auto result_poll = int { };
+
+    do
+    {
+      result_poll = ::poll(&pfd, static_cast<::nfds_t>(UINT8_C(1)), stall_timeout_ms);
+    }
+    while((result_poll < 0) && (errno == EINTR));
+
+    return (result_poll > 0);
+  }
+
+  auto make_pty(int& controller_fd, int& follower_fd) -> bool
+  {
+    controller_fd = ::posix_openpt(O_RDWR | O_NOCTTY | O_CLOEXEC);
+
+    const auto result_pty_is_ok =
+      (   (controller_fd >= 0)
+       && (::grantpt (controller_fd) == 0)
+       && (::unlockpt(controller_fd) == 0));
+
+    follower_fd =
+      (result_pty_is_ok ? ::open(::ptsname(controller_fd), O_RDWR | O_NOCTTY | O_CLOEXEC) : -1);
+
+    return (follower_fd >= 0);
+  }
+
+  auto make_loopback(int& client_fd, int& server_fd) -> bool
+  {
+    auto listen_fd = ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+    auto addr = ::sockaddr_in { };
+
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = ::htonl(INADDR_LOOPBACK);
+    addr.sin_port        = static_cast<::in_port_t>(UINT8_C(0));
+
+    auto addr_len = static_cast<::socklen_t>(sizeof(addr));
+
+    const auto result_listen_is_ok =
+      (   (listen_fd >= 0)
+       && (::bind(listen_fd, reinterpret_cast<::sockaddr*>(&addr), addr_len) == 0)
+       && (::listen(listen_fd, 1) == 0)
+       && (::getsockname(listen_fd, reinterpret_cast<::sockaddr*>(&addr), &addr_len) == 0));
+
+    client_fd = (result_listen_is_ok ? ::socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0) : -1);
+
+    const auto result_connect_is_ok =
+      (   (client_fd >= 0)
+       && (::connect(client_fd, reinterpret_cast<::sockaddr*>(&addr), addr_len) == 0));
+
+    server_fd = (result_connect_is_ok ? ::accept4(listen_fd, nullptr, nullptr, SOCK_CLOEXEC) : -1);
+
+    close_fd(listen_fd);
+
+    return (server_fd >= 0);
+  }
+
+  auto write_all(const int fd, const std::uint8_t* data, const std::size_t size) -> bool
+  {
+    auto count = static_cast<std::size_t>(UINT8_C(0));
+
+    while(count < size)
+    {
+      const auto n = ::write(fd, data + count, size - count);
+
+      if(n > static_cast<::ssize_t>(0))
+      {
+        count += static_cast<std::size_t>(n);
+      }
+      else if((n < static_cast<::ssize_t>(0)) && ((errno == EAGAIN) || (errno == EINTR)))
+      {
+        if(!wait_for(fd, static_cast<short>(POLLOUT))) { return false; }
+      }
+      else
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  // Read at least one byte. Returns the count, or 0 on error, end of
+  // file or stall.
+  auto read_some(const int fd, std::uint8_t* data, const std::size_t size) -> std::size_t
+  {
+    for(;;)
+    {
+      const auto n = ::read(fd, data, size);
+
+      if(n > static_cast<::ssize_t>(0))
+      {
+        return static_cast<std::size_t>(n);
+      }
+
+      if(   (n == static_cast<::ssize_t>(0))
+         || ((errno != EAGAIN) && (errno != EINTR))
+         || (!wait_for(fd, static_cast<short>(POLLIN))))
+      {
+        return static_cast<std::size_t>(UINT8_C(0));
+      }
+    }
+  }
+
+  auto read_exact(const int fd, std::uint8_t* data, const std::size_t size) -> bool
+  {
+    auto count = static_cast<std::size_t>(UINT8_C(0));
+
+    while(count < size)
+    {
+      const auto n = read_some(fd, data + count, size - count);
+
+      if(n == static_cast<std::size_t>(UINT8_C(0))) { return false; }
+
+      count += n;
+    }
+
+    return true;
+  }
+
+  // Stream a verifiable pattern of the given size from src_fd to
+  // dst_fd. Returns true if all of it arrived intact.
+  auto run_stream(const int src_fd, const int dst_fd, const std::size_t total) -> bool
+  {
+    const auto chunk = static_cast<std::size_t>(UINT16_C(0x4000));
+
+    auto writer =
+      std::thread
+      (
+        [src_fd, chunk, total]()
+        {
+          auto buf = std::vector<std::uint8_t>(chunk);
+
+          for(auto offset = static_cast<std::size_t>(UINT8_C(0)); offset < total; offset += chunk)
+          {
+            for(auto i = static_cast<std::size_t>(UINT8_C(0)); i < chunk; ++i)
+            {
+              buf[i] = pattern_byte(offset + i);
+            }
+
+            if(!write_all(src_fd, buf.data(), chunk)) { break; }
+          }
+        }
+      );
+
+    auto buf = std::vector<std::uint8_t>(chunk);
+
+    auto received = static_cast<std::size_t>(UINT8_C(0));
+    auto intact   = true;
+
+    while((received < total) && intact)
+    {
+      const auto n = read_some(dst_fd, buf.data(), buf.size());
+
+      intact = (n != static_cast<std::size_t>(UINT8_C(0)));
+
+      for(auto i = static_cast<std::size_t>(UINT8_C(0)); (i < n) && intact; ++i)
+      {
+        intact = (buf[i] == pattern_byte(received + i));
+      }
+
+      received += n;
+    }
+
+    writer.join();
+
+    return intact;
+  }
+
+  // Run all streams concurrently. Returns their aggregate MiB/s,
+  // or a negative value if any of them did not arrive intact.
+  auto run_streams(const std::vector<std::pair<int, int>>& streams, const std::size_t total) -> double
+  {
+    auto results = std::vector<char>(streams.size(), static_cast<char>(0));
+
+    auto threads = std::vector<std::thread> { };
+
+    const auto start = clock_type::now();
+
+    for(auto index = static_cast<std::size_t>(UINT8_C(0)); index < streams.size(); ++index)
+    {
+      threads.emplace_back
+      (
+        [&streams, &results, index, total]()
+        {
+          results[index] = static_cast<char>(run_stream(streams[index].first, streams[index].second, total));
+        }
+      );
+    }
+
+    for(auto& th : threads)
+    {
+      th.join();
+    }
+
+    const auto elapsed = std::chrono::duration<double>(clock_type::now() - start).count();
+
+    const auto result_all_are_intact =
+      std::all_of(results.cbegin(), results.cend(), [](const char r) { return (r != static_cast<char>(0)); });
+
+    const auto mib = (static_cast<double>(total * streams.size()) / (1024.0 * 1024.0));
+
+    return (result_all_are_intact ? (mib / elapsed) : -1.0);
+  }
+
+  // One-byte round trips device -> tool -> device. Returns the
+  // sorted round-trip times in microseconds (empty on failure).
+  auto run_latency(const int device_fd, const int tool_fd) -> std::vector<double>
+  {
+    auto samples = std::vector<double> { };
+
+    samples.reserve(latency_rounds);
+
+    for(auto round = static_cast<std::size_t>(UINT8_C(0)); round < latency_rounds; ++round)
+    {
+      auto byte = pattern_byte(round);
+
+      const auto start = clock_type::now();
+
+      const auto result_round_is_ok =
+        (   write_all (device_fd, &byte, static_cast<std::size_t>(UINT8_C(1)))
+         && read_exact(tool_fd,   &byte, static_cast<std::size_t>(UINT8_C(1)))
+         && write_all (tool_fd,   &byte, static_cast<std::size_t>(UINT8_C(1)))
+         && read_exact(device_fd, &byte, static_cast<std::size_t>(UINT8_C(1)))
+         && (byte == pattern_byte(round)));
+
+      if(!result_round_is_ok)
+      {
+        return std::vector<double> { };
+      }
+
+      samples.push_back(std::chrono::duration<double, std::micro>(clock_type::now() - start).count());
+    }
+
+    std::sort(samples.begin(), samples.end());
+
+    return samples;
+  }
+
+  // One pty/loopback pair bridged by the gateway. Owns every
+  // descriptor that has not been handed over to the port or to
+  // the gateway, so that no early return can leak them.
+  class link_fixture
+  {
+  public:
+    link_fixture() = default;
+
+    link_fixture(const link_fixture&) = delete;
+    link_fixture(link_fixture&&) noexcept = delete;
+
+    auto operator=(const link_fixture&) -> link_fixture& = delete;
+    auto operator=(link_fixture&&) noexcept -> link_fixture& = delete;
+
+    ~link_fixture()
+    {
+      close_fd(controller_fd);
+      close_fd(client_fd);
+    }
+
+    auto open(serial_gateway& gateway,
+              const bool      follower_is_append = false,
+              const bool      allow_half_close   = false) -> bool
+    {
+      auto follower_fd = int { -1 };
+
+      if(!make_pty(controller_fd, follower_fd))
+      {
+        close_fd(follower_fd);
+
+        return false;
+      }
+
+      if(follower_is_append)
+      {
+        static_cast<void>(::fcntl(follower_fd, F_SETFL, ::fcntl(follower_fd, F_GETFL) | O_APPEND));
+      }
+
+      port = std::make_unique<serial_posix>(serial_posix::adopt_native_handle_type { },
+                                            follower_fd,
+                                            static_cast<std::uint32_t>(UINT32_C(115200)));
+
+      return
+        (   port->valid()
+         && set_nonblocking(controller_fd)
+         && attach(gateway, client_fd, allow_half_close));
+    }
+
+    // Bridge this fixture's port to a new loopback connection whose
+    // client end is returned in tool_fd (owned by the caller).
+    auto attach(serial_gateway& gateway, int& tool_fd, const bool allow_half_close = false) -> bool
+    {
+      auto server_fd = int { -1 };
+
+      const auto result_attach_is_ok =
+        (   make_loopback(tool_fd, server_fd)
+         && set_nonblocking(tool_fd)
+         && gateway.add(*port, server_fd, allow_half_close));
+
+      if(!result_attach_is_ok)
+      {
+        // The gateway owns the server socket only after a successful add().
+        close_fd(server_fd);
+      }
+
+      return result_attach_is_ok;
+    }
+
+    auto serial_port() const -> const serial_posix& { return *port; }
+
+    int controller_fd { -1 };
+    int client_fd     { -1 };
+
+  private:
+    std::unique_ptr<serial_posix> port { };
+  };
+
+  auto run_mode(const char* name, const bool use_splice, const std::size_t link_count, const bool follower_is_append) -> bool
+  {
+    // Declared before the gateway, so that the gateway (and with it
+    // the links) goes away before the ports it refers to.
+    auto fixtures = std::vector<std::unique_ptr<link_fixture>> { };
+
+    serial_gateway gateway { use_splice };
+
+    auto result_setup_is_ok = gateway.valid();
+
+    for(auto index = static_cast<std::size_t>(UINT8_C(0)); (index < link_count) && result_setup_is_ok; ++index)
+    {
+      fixtures.push_back(std::make_unique<link_fixture>());
+
+      result_setup_is_ok = fixtures.back()->open(gateway, follower_is_append);
+    }
+
+    if(!result_setup_is_ok)
+    {
+      std::printf("%-8s setup FAILED\n", name);
+
+      return false;
+    }
+
+    std::atomic<bool> stop { false };
+
+    auto gateway_thread =
+      std::thread
+      (
+        [&gateway, &stop]()
+        {
+          while(!stop.load())
+          {
+            static_cast<void>(gateway.poll(static_cast<int>(INT8_C(10))));
+          }
+        }
+      );
+
+    auto result_mode_is_ok = bool { };
+
+    if(link_count == static_cast<std::size_t>(UINT8_C(1)))
+    {
+      const auto& fx = *fixtures.front();
+
+      const auto mib_to_tool   = run_streams({ { fx.controller_fd, fx.client_fd } }, throughput_bytes);
+      const auto mib_to_device = run_streams({ { fx.client_fd, fx.controller_fd } }, throughput_bytes);
+      const auto rtt_us        = run_latency(fx.controller_fd, fx.client_fd);
+
+      result_mode_is_ok = ((mib_to_tool > 0.0) && (mib_to_device > 0.0) && (!rtt_us.empty()));
+
+      std::printf("%-8s serial->tcp: %8.1f MiB/s, tcp->serial: %8.1f MiB/s",
+                  name,
+                  mib_to_tool,
+                  mib_to_device);
+
+      if(!rtt_us.empty())
+      {
+        std::printf(", rtt median: %6.1f us, p99: %6.1f us",
+                    rtt_us[rtt_us.size() / 2U],
+                    rtt_us[(rtt_us.size() * 99U) / 100U]);
+      }
+    }
+    else
+    {
+      // Both directions of every link at once.
+      auto streams = std::vector<std::pair<int, int>> { };
+
+      for(const auto& fx : fixtures)
+      {
+        streams.emplace_back(fx->controller_fd, fx->client_fd);
+        streams.emplace_back(fx->client_fd, fx->controller_fd);
+      }
+
+      const auto mib_total = run_streams(streams, multi_bytes);
+
+      result_mode_is_ok = ((mib_total > 0.0) && (gateway.link_count() == link_count));
+
+      std::printf("%-8s %u links, %u streams, total: %8.1f MiB/s",
+                  name,
+                  static_cast<unsigned>(link_count),
+                  static_cast<unsigned>(streams.size()),
+                  mib_total);
+    }
+
+    stop.store(true);
+
+    gateway_thread.join();
+
+    std::printf("%s\n", (result_mode_is_ok ? "" : " (FAILED)"));
+
+    return result_mode_is_ok;
+  }
+
+  // Serve the gateway from the calling thread for a little while.
+  auto settle(serial_gateway& gateway) -> void
+  {
+    for(auto round = static_cast<unsigned>(UINT8_C(0)); round < static_cast<unsigned>(UINT8_C(20)); ++round)
+    {
+      static_cast<void>(gateway.poll(static_cast<int>(INT8_C(5))));
+    }
+  }
+
+  // Serve the gateway, then check that exactly msg can be read from fd.
+  auto arrives(serial_gateway& gateway, const int fd, const char* msg) -> bool
+  {
+    settle(gateway);
+
+    auto buf = std::array<char, static_cast<std::size_t>(UINT8_C(64))> { };
+
+    const auto n = ::read(fd, buf.data(), buf.size());
+
+    return
+      (   (n == static_cast<::ssize_t>(std::strlen(msg)))
+       && (std::memcmp(buf.data(), msg, std::strlen(msg)) == 0));
+  }
+
+  auto passes(serial_gateway& gateway, const int src_fd, const int dst_fd, const char* msg) -> bool
+  {
+    return
+      (   write_all(src_fd, reinterpret_cast<const std::uint8_t*>(msg), std::strlen(msg))
+       && arrives(gateway, dst_fd, msg));
+  }
+
+  auto sees_eof(serial_gateway& gateway, const int fd) -> bool
+  {
+    settle(gateway);
+
+    auto byte = std::uint8_t { };
+
+    return (::read(fd, &byte, static_cast<std::size_t>(UINT8_C(1))) == static_cast<::ssize_t>(0));
+  }
+
+  auto report(const char* name, const bool result_is_ok) -> bool
+  {
+    std::printf("check    %-40s %s\n", name, (result_is_ok ? "ok" : "FAILED"));
+
+    return result_is_ok;
+  }
+
+  auto check_duplicate_add() -> bool
+  {
+    link_fixture fx { };
+
+    serial_gateway gateway { };
+
+    auto second_fd = int { -1 };
+
+    // Bridging the same port a second time must fail and leave the
+    // existing link passing data in both directions.
+    const auto result_check_is_ok =
+      (   fx.open(gateway)
+       && (!fx.attach(gateway, second_fd))
+       && (gateway.link_count() == static_cast<std::size_t>(UINT8_C(1)))
+       && passes(gateway, fx.controller_fd, fx.client_fd, "abc")
+       && passes(gateway, fx.client_fd, fx.controller_fd, "xyz"));
+
+    close_fd(second_fd);
+
+    return report("duplicate add() is rejected", result_check_is_ok);
+  }
+
+  auto check_half_close() -> bool
+  {
+    link_fixture fx { };
+
+    serial_gateway gateway { };
+
+    // The tool sends a command and half-closes. The command and the
+    // device's reply must still get through.
+    auto result_check_is_ok =
+      (   fx.open(gateway, false, true)
+       && write_all(fx.client_fd, reinterpret_cast<const std::uint8_t*>("cmd"), static_cast<std::size_t>(UINT8_C(3)))
+       && (::shutdown(fx.client_fd, SHUT_WR) == 0)
+       && arrives(gateway, fx.controller_fd, "cmd")
+       && passes(gateway, fx.controller_fd, fx.client_fd, "resp"));
+
+    // Once the device hangs up, the tool must see end-of-file.
+    close_fd(fx.controller_fd);
+
+    result_check_is_ok =
+      (   result_check_is_ok
+       && sees_eof(gateway, fx.client_fd)
+       && (gateway.link_count() == static_cast<std::size_t>(UINT8_C(0))));
+
+    return report("half-close keeps the reply flowing", result_check_is_ok);
+  }
+
+  auto check_reconnect() -> bool
+  {
+    link_fixture fx { };
+
+    serial_gateway gateway { };
+
+    // The client closes while the device stays quiet. The port must
+    // be free for the next client right away.
+    auto result_check_is_ok = fx.open(gateway);
+
+    close_fd(fx.client_fd);
+
+    settle(gateway);
+
+    result_check_is_ok =
+      (   result_check_is_ok
+       && (gateway.link_count() == static_cast<std::size_t>(UINT8_C(0)))
+       && fx.attach(gateway, fx.client_fd)
+       && passes(gateway, fx.controller_fd, fx.client_fd, "abc")
+       && passes(gateway, fx.client_fd, fx.controller_fd, "xyz"));
+
+    const auto result_remove_is_ok =
+      (   result_check_is_ok
+       && gateway.remove(fx.serial_port())
+       && (!gateway.remove(fx.serial_port()))
+       && (gateway.link_count() == static_cast<std::size_t>(UINT8_C(0)))
+       && sees_eof(gateway, fx.client_fd));
+
+    return
+      (   report("reconnect after the client closes", result_check_is_ok)
+       && report("remove() ends the link", result_remove_is_ok));
+  }
+
+  auto check_small_chunk_size() -> bool
+  {
+    link_fixture fx { };
+
+    serial_gateway gateway { true, static_cast<std::size_t>(::sysconf(_SC_PAGESIZE) / 2L) };
+
+    const auto result_check_is_ok =
+      (   (!gateway.valid())
+       && (!fx.open(gateway))
+       && (gateway.link_count() == static_cast<std::size_t>(UINT8_C(0))));
+
+    return report("chunk size below one page is rejected", result_check_is_ok);
+  }
+} // namespace local
+
+auto main() -> int
+{
+  // Writing into a reset connection must fail, not terminate.
+  static_cast<void>(std::signal(SIGPIPE, SIG_IGN));
+
+  const auto result_duplicate_is_ok  = local::check_duplicate_add();
+  const auto result_half_close_is_ok = local::check_half_close();
+  const auto result_reconnect_is_ok  = local::check_reconnect();
+  const auto result_chunk_size_is_ok = local::check_small_chunk_size();
+
+  const auto result_splice_is_ok   = local::run_mode("splice",   true,  static_cast<std::size_t>(UINT8_C(1)), false);
+  const auto result_buffered_is_ok = local::run_mode("buffered", false, static_cast<std::size_t>(UINT8_C(1)), false);
+  const auto result_fallback_is_ok = local::run_mode("fallback", true,  static_cast<std::size_t>(UINT8_C(1)), true);
+  const auto result_multi_is_ok    = local::run_mode("multi",    true,  local::multi_links,                  false);
+
+  const auto result_is_ok =
+    (   result_duplicate_is_ok
+     && result_half_close_is_ok
+     && result_reconnect_is_ok
+     && result_chunk_size_is_ok
+     && result_splice_is_ok
+     && result_buffered_is_ok
+     && result_fallback_is_ok
+     && result_multi_is_ok);
+
+  return (result_is_ok ? EXIT_SUCCESS : EXIT_FAILURE);
+}
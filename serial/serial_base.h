@@ -0,0 +1,163 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 1998, 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SERIAL_BASE_1998_11_23_H
+  #define SERIAL_BASE_1998_11_23_H
+
+  #include <array>
+  #include <cstddef>
+  #include <cstdint>
+  #include <limits>
+  #include <vector>
+
+  struct t_scb
+  {
+    explicit t_scb(const std::uint32_t ch,
+                   const std::uint32_t bd     = static_cast<std::uint32_t>(UINT32_C(9600)),
+                   const std::uint32_t n_send = static_cast<std::uint32_t>(UINT32_C(0x10000)),
+                   const std::uint32_t n_recv = static_cast<std::uint32_t>(UINT32_C(0x10000)))
+      : channel     (ch),
+        baud        (bd),
+        send_buf_len(n_send),
+        recv_buf_len(n_recv) { }
+
+    t_scb() = delete;
+
+    ~t_scb() = default;
+
+    t_scb(const t_scb&) = default;
+    t_scb(t_scb&&) noexcept = default;
+
+    auto operator=(const t_scb&) -> t_scb& = default;
+    auto operator=(t_scb&&) noexcept -> t_scb& = default;
+
+    std::uint32_t channel { static_cast<std::uint32_t>(UINT8_C(1)) };
+    std::uint32_t baud    { static_cast<std::uint32_t>(UINT16_C(9600)) };
+
+    std::uint32_t send_buf_len { static_cast<std::uint32_t>(UINT32_C(0x10000)) };
+    std::uint32_t recv_buf_len { static_cast<std::uint32_t>(UINT32_C(0x10000)) };
+  };
+
+  class serial_base
+  {
+  public:
+    static constexpr auto open_Ok                    = static_cast<int>(INT16_C(0x00000000));
+    static constexpr auto open_BadChannelNumber      = static_cast<int>(INT16_C(0x00000001));
+    static constexpr auto open_ChannelInUse          = static_cast<int>(INT16_C(0x00000002));
+    static constexpr auto open_ChannelNotAvailable   = static_cast<int>(INT16_C(0x00000004));
+    static constexpr auto open_NotEnoughMemory       = static_cast<int>(INT16_C(0x00000008));
+    static constexpr auto open_InvalidParams         = static_cast<int>(INT16_C(0x00000010));
+    static constexpr auto open_BadBufferSize         = static_cast<int>(INT16_C(0x00000020));
+    static constexpr auto open_BaudAdjusted          = static_cast<int>(INT16_C(0x00000100));
+    static constexpr auto open_BitsAdjusted          = static_cast<int>(INT16_C(0x00000200));
+    static constexpr auto open_StopAdjusted          = static_cast<int>(INT16_C(0x00000400));
+    static constexpr auto open_ParityAdjusted        = static_cast<int>(INT16_C(0x00000800));
+    static constexpr auto open_ModeAdjusted          = static_cast<int>(INT16_C(0x00001000));
+    static constexpr auto open_ReceiveBufferAdjusted = static_cast<int>(INT16_C(0x00002000));
+    static constexpr auto open_SendBufferAdjusted    = static_cast<int>(INT16_C(0x00004000));
+    static constexpr auto open_Error                 = static_cast<int>(  open_BadChannelNumber
+                                                                        | open_ChannelInUse
+                                                                        | open_ChannelNotAvailable
+                                                                        | open_NotEnoughMemory
+                                                                        | open_InvalidParams);
+
+    explicit serial_base(const std::uint32_t ch,
+                         const std::uint32_t bd     = static_cast<std::uint32_t>(UINT16_C(9600)),
+                         const std::uint32_t n_send = static_cast<std::uint32_t>(UINT32_C(0x10000)),
+                         const std::uint32_t n_recv = static_cast<std::uint32_t>(UINT32_C(0x10000)))
+      : m_scb(ch, bd, n_send, n_recv) { }
+
+    serial_base() = delete;
+
+    serial_base(const serial_base&) = delete;
+    serial_base(serial_base&&) noexcept = delete;
+
+    auto operator=(const serial_base&) -> serial_base& = delete;
+    auto operator=(serial_base&&) noexcept -> serial_base& = delete;
+
+    virtual ~serial_base() = default;
+
+    virtual auto open(const t_scb& scb, std::uint32_t& result) -> bool = 0;
+    virtual auto close() -> bool = 0;
+
+    virtual auto recv(::std::vector<std::uint8_t>& data) const -> std::uint32_t = 0;
+
+    virtual auto send_in_progress() const -> bool = 0;
+    virtual auto recv_ready() const -> std::uint32_t = 0;
+
+    auto send(const ::std::vector<std::uint8_t>& data) -> bool
+    {
+      return this->do_send(data);
+    }
+
+    template<typename InputIteratorType>
+    auto send_n(InputIteratorType first, InputIteratorType last) -> bool
+    {
+      return this->do_send(::std::vector<std::uint8_t>(first, last));
+    }
+
+    auto send(const std::uint8_t b) -> bool
+    {
+      using local_array_one_byte_type = ::std::array<std::uint8_t, static_cast<std::size_t>(UINT8_C(1))>;
+
+      const auto ar1 = local_array_one_byte_type { b };
+
+      return send_n(ar1.cbegin(), ar1.cend());
+    }
+
+    auto set_chan(const std::uint32_t ch) -> bool
+    {
+      auto result_set_chan_is_ok = bool { };
+
+      if((!m_is_error) && (!m_is_open))
+      {
+        m_scb.channel = ch;
+
+        result_set_chan_is_ok = true;
+      }
+      else
+      {
+        result_set_chan_is_ok = false;
+      }
+
+      return result_set_chan_is_ok;
+    }
+
+    auto set_baud(const std::uint32_t bd) -> bool
+    {
+      auto result_set_baud_is_ok = bool { };
+
+      if((!m_is_error) && (!m_is_open))
+      {
+        m_scb.baud = bd;
+
+        result_set_baud_is_ok = true;
+      }
+      else
+      {
+        result_set_baud_is_ok = false;
+      }
+
+      return result_set_baud_is_ok;
+    }
+
+    [[nodiscard]] auto valid() const -> bool { return (is_open() && (!is_error())); }
+
+  protected:
+    t_scb m_scb { (std::numeric_limits<std::uint32_t>::max)() };
+
+    bool m_is_open  { false };
+    bool m_is_error { false };
+
+    [[nodiscard]] auto is_open () const -> bool { return m_is_open;  }
+    [[nodiscard]] auto is_error() const -> bool { return m_is_error; }
+
+  private:
+    virtual auto do_send(const ::std::vector<std::uint8_t>& data) -> bool = 0;
+  };
+
+#endif // SERIAL_BASE_1998_11_23_H
@@ -0,0 +1,650 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SERIAL_GATEWAY_2026_10_19_H
+  #define SERIAL_GATEWAY_2026_10_19_H
+
+  #include <algorithm>
+  #include <array>
+  #include <cerrno>
+  #include <cstddef>
+  #include <cstdint>
+  #include <initializer_list>
+  #include <memory>
+  #include <vector>
+
+  #include <fcntl.h>
+  #include <netinet/in.h>
+  #include <netinet/tcp.h>
+  #include <sys/epoll.h>
+  #include <sys/socket.h>
+  #include <unistd.h>
+
+  #include <serial_posix.h>
+
+  // Bridge serial ports to TCP sockets (in the manner of ser2net).
+  // A single gateway multiplexes any number of port/socket links
+  // with one epoll set and is intended to be driven by one thread.
+  // Bytes are moved with splice(2) through a per-direction pipe,
+  // so they never enter user space. Where the kernel refuses to
+  // splice a given descriptor (EINVAL, ENOSYS or EOPNOTSUPP), that
+  // direction falls back to a buffer borrowed from a shared pool
+  // only while data is in flight.
+  // Each direction holds at most one chunk in transit. Reading
+  // from the source stops while the chunk is not yet drained into
+  // the sink, so backpressure propagates into the kernel queues
+  // (the TCP window or the tty driver) in both directions.
+
+  class serial_gateway
+  {
+  public:
+    // The chunk size bounds the data in transit per direction. It must
+    // be at least one page, otherwise the gateway is not valid().
+    explicit serial_gateway(const bool          use_splice = true,
+                            const std::size_t   chunk_size = static_cast<std::size_t>(UINT32_C(0x10000)))
+      : my_use_splice      (use_splice),
+        my_chunk_size      (chunk_size),
+        my_chunk_size_is_ok(chunk_size >= page_size()),
+        my_epoll_fd        (::epoll_create1(EPOLL_CLOEXEC)) { }
+
+    serial_gateway(const serial_gateway&) = delete;
+    serial_gateway(serial_gateway&&) noexcept = delete;
+
+    auto operator=(const serial_gateway&) -> serial_gateway& = delete;
+    auto operator=(serial_gateway&&) noexcept -> serial_gateway& = delete;
+
+    ~serial_gateway()
+    {
+      for(auto& lnk : my_links)
+      {
+        close_link(*lnk, true);
+      }
+
+      if(my_epoll_fd >= 0)
+      {
+        static_cast<void>(::close(my_epoll_fd));
+      }
+    }
+
+    [[nodiscard]] auto valid() const -> bool { return (my_chunk_size_is_ok && (my_epoll_fd >= 0)); }
+
+    [[nodiscard]] auto link_count() const -> std::size_t { return my_links.size(); }
+
+    // Bridge the port to a connected stream socket. On success the
+    // gateway takes ownership of the socket and closes it when the link
+    // ends. By default that happens as soon as the peer closes (or
+    // half-closes) the connection, so that the port is free again for
+    // the next client even if the device never speaks. With
+    // allow_half_close, end-of-file from the peer only ends the
+    // socket-to-serial direction. The device's replies then keep
+    // flowing until the serial side ends too, which is passed on as
+    // a half-close, and the link ends once both directions have ended.
+    // Either way, a link also ends on a hangup, when writing to either
+    // side fails, or by remove(). On failure the socket remains with
+    // the caller. Since splice(2) into a reset socket raises SIGPIPE,
+    // the application should ignore that signal.
+    // The port is not owned and must outlive the link. Each port (and
+    // each socket) can take part in only one link at a time, so adding
+    // a port that is already bridged fails.
+    auto add(serial_posix& port, const int socket_fd, const bool allow_half_close = false) -> bool
+    {
+      auto result_add_is_ok = bool { };
+
+      if(valid() && port.valid() && (socket_fd >= 0) && (!is_bridged(port.native_handle(), socket_fd)))
+      {
+        auto lnk = std::make_unique<link_type>();
+
+        lnk->serial.fd   = port.native_handle();
+        lnk->serial.out  = &lnk->serial_to_socket;
+        lnk->serial.in   = &lnk->socket_to_serial;
+        lnk->serial.lnk  = lnk.get();
+
+        lnk->socket.fd   = socket_fd;
+        lnk->socket.out  = &lnk->socket_to_serial;
+        lnk->socket.in   = &lnk->serial_to_socket;
+        lnk->socket.lnk  = lnk.get();
+
+        lnk->serial_to_socket.src = lnk->serial.fd;
+        lnk->serial_to_socket.dst = lnk->socket.fd;
+        lnk->socket_to_serial.src = lnk->socket.fd;
+        lnk->socket_to_serial.dst = lnk->serial.fd;
+
+        lnk->allow_half_close = allow_half_close;
+
+        // Non-blocking socket with Nagle disabled for interactive latency.
+        const auto fd_flags = ::fcntl(socket_fd, F_GETFL);
+
+        const auto nodelay = static_cast<int>(INT8_C(1));
+
+        static_cast<void>(::setsockopt(socket_fd, IPPROTO_TCP, TCP_NODELAY, &nodelay, sizeof(nodelay)));
+
+        open_direction(lnk->serial_to_socket);
+        open_direction(lnk->socket_to_serial);
+
+        result_add_is_ok =
+          (   (fd_flags >= 0)
+           && (::fcntl(socket_fd, F_SETFL, fd_flags | O_NONBLOCK) == 0)
+           && watch(lnk->serial, EPOLL_CTL_ADD)
+           && watch(lnk->socket, EPOLL_CTL_ADD));
+
+        if(result_add_is_ok)
+        {
+          my_links.push_back(std::move(lnk));
+        }
+        else
+        {
+          close_link(*lnk, false);
+        }
+      }
+      else
+      {
+        result_add_is_ok = false;
+      }
+
+      return result_add_is_ok;
+    }
+
+    // End the port's link, if any, and close its socket. This must not
+    // be called concurrently with poll(). Returns false if the port
+    // was not bridged.
+    auto remove(const serial_posix& port) -> bool
+    {
+      const auto it_link =
+        std::find_if(my_links.begin(),
+                     my_links.end(),
+                     [&port](const std::unique_ptr<link_type>& lnk)
+                     {
+                       return (lnk->serial.fd == port.native_handle());
+                     });
+
+      const auto result_remove_is_ok = (it_link != my_links.end());
+
+      if(result_remove_is_ok)
+      {
+        close_link(**it_link, true);
+
+        my_links.erase(it_link);
+      }
+
+      return result_remove_is_ok;
+    }
+
+    // Wait up to timeout_ms for activity and service all ready links.
+    // Returns the number of links that remain active afterwards.
+    auto poll(const int timeout_ms) -> std::size_t
+    {
+      using local_event_array_type = std::array<::epoll_event, static_cast<std::size_t>(UINT8_C(64))>;
+
+      auto events = local_event_array_type { };
+
+      const auto event_count =
+        ::epoll_wait(my_epoll_fd, events.data(), static_cast<int>(events.size()), timeout_ms);
+
+      for(auto index = static_cast<int>(INT8_C(0)); index < event_count; ++index)
+      {
+        auto& ep  = *static_cast<endpoint_type*>(events[static_cast<std::size_t>(index)].data.ptr);
+        auto& lnk = *ep.lnk;
+
+        const auto ev = events[static_cast<std::size_t>(index)].events;
+
+        if(!lnk.is_done)
+        {
+          if((ev & static_cast<std::uint32_t>(EPOLLIN | EPOLLHUP | EPOLLERR)) != static_cast<std::uint32_t>(UINT8_C(0)))
+          {
+            pump(*ep.out);
+          }
+
+          if((ev & static_cast<std::uint32_t>(EPOLLOUT | EPOLLHUP | EPOLLERR)) != static_cast<std::uint32_t>(UINT8_C(0)))
+          {
+            pump(*ep.in);
+          }
+
+          const auto is_hangup =
+            ((ev & static_cast<std::uint32_t>(EPOLLHUP | EPOLLERR)) != static_cast<std::uint32_t>(UINT8_C(0)));
+
+          // Unless half-closing is allowed, end-of-file from the peer
+          // ends the whole link.
+          const auto is_peer_closed =
+            ((!lnk.allow_half_close) && is_finished(lnk.socket_to_serial));
+
+          if(is_hangup || is_peer_closed)
+          {
+            // The link ends, but first hand on what is already in transit.
+            final_drain(lnk.serial_to_socket);
+            final_drain(lnk.socket_to_serial);
+          }
+
+          // A half-closed connection only ends its own direction. The
+          // device's replies keep flowing to the tool until the serial
+          // side ends too, which is then passed on as a half-close.
+          if(is_finished(lnk.serial_to_socket) && (!lnk.is_shut_wr))
+          {
+            static_cast<void>(::shutdown(lnk.socket.fd, SHUT_WR));
+
+            lnk.is_shut_wr = true;
+          }
+
+          lnk.is_done =
+            (   is_hangup
+             || is_peer_closed
+             || lnk.serial_to_socket.is_error
+             || lnk.socket_to_serial.is_error
+             || (is_finished(lnk.serial_to_socket) && is_finished(lnk.socket_to_serial)));
+
+          if(!lnk.is_done)
+          {
+            lnk.is_done = (!(update_interest(lnk.serial) && update_interest(lnk.socket)));
+          }
+        }
+      }
+
+      // Retire finished links only after the whole event batch has been
+      // handled, since later events in the batch may still refer to them.
+      for(auto& lnk : my_links)
+      {
+        if(lnk->is_done) { close_link(*lnk, true); }
+      }
+
+      const auto it_done =
+        std::remove_if(my_links.begin(),
+                       my_links.end(),
+                       [](const std::unique_ptr<link_type>& lnk)
+                       {
+                         return lnk->is_done;
+                       });
+
+      my_links.erase(it_done, my_links.end());
+
+      return my_links.size();
+    }
+
+  private:
+    struct buffer_type
+    {
+      std::unique_ptr<std::uint8_t[]> data { };
+
+      std::size_t head { static_cast<std::size_t>(UINT8_C(0)) };
+      std::size_t tail { static_cast<std::size_t>(UINT8_C(0)) };
+    };
+
+    struct direction_type
+    {
+      int src { -1 };
+      int dst { -1 };
+
+      bool use_splice { false };
+
+      int         pipe_rd   { -1 };
+      int         pipe_wr   { -1 };
+      std::size_t pipe_size { static_cast<std::size_t>(UINT8_C(0)) };
+      std::size_t in_pipe   { static_cast<std::size_t>(UINT8_C(0)) };
+      bool        pipe_full { false };
+
+      buffer_type buf { };
+
+      bool src_eof  { false };
+      bool is_error { false };
+    };
+
+    struct link_type;
+
+    struct endpoint_type
+    {
+      int fd { -1 };
+
+      direction_type* out { nullptr }; // Direction for which this descriptor is the source.
+      direction_type* in  { nullptr }; // Direction for which this descriptor is the sink.
+
+      link_type* lnk { nullptr };
+
+      std::uint32_t interest { static_cast<std::uint32_t>(UINT8_C(0)) };
+
+      bool is_watched { false };
+    };
+
+    struct link_type
+    {
+      endpoint_type serial { };
+      endpoint_type socket { };
+
+      direction_type serial_to_socket { };
+      direction_type socket_to_serial { };
+
+      bool allow_half_close { false };
+      bool is_shut_wr       { false };
+      bool is_done          { false };
+    };
+
+    const bool        my_use_splice;
+    const std::size_t my_chunk_size;
+    const bool        my_chunk_size_is_ok;
+    const int         my_epoll_fd;
+
+    std::vector<std::unique_ptr<link_type>> my_links { };
+
+    std::vector<std::unique_ptr<std::uint8_t[]>> my_buffer_pool { };
+
+    static auto page_size() -> std::size_t
+    {
+      const auto result_page_size = ::sysconf(_SC_PAGESIZE);
+
+      return
+        ((result_page_size > 0L) ? static_cast<std::size_t>(result_page_size)
+                                 : static_cast<std::size_t>(UINT16_C(4096)));
+    }
+
+    auto is_bridged(const int serial_fd, const int socket_fd) const -> bool
+    {
+      return
+        std::any_of(my_links.cbegin(),
+                    my_links.cend(),
+                    [serial_fd, socket_fd](const std::unique_ptr<link_type>& lnk)
+                    {
+                      return ((lnk->serial.fd == serial_fd) || (lnk->socket.fd == socket_fd));
+                    });
+    }
+
+    static auto has_pending(const direction_type& d) -> bool
+    {
+      return ((d.in_pipe != static_cast<std::size_t>(UINT8_C(0))) || (d.buf.head != d.buf.tail));
+    }
+
+    static auto is_finished(const direction_type& d) -> bool
+    {
+      return (d.src_eof && (!has_pending(d)));
+    }
+
+    auto has_room(const direction_type& d) const -> bool
+    {
+      return
+        (d.use_splice ? ((d.in_pipe < d.pipe_size) && (!d.pipe_full))
+                      :  (d.buf.tail < my_chunk_size));
+    }
+
+    auto open_direction(direction_type& d) -> void
+    {
+      auto pipe_fds = std::array<int, static_cast<std::size_t>(UINT8_C(2))> { -1, -1 };
+
+      d.use_splice = (my_use_splice && (::pipe2(pipe_fds.data(), O_NONBLOCK | O_CLOEXEC) == 0));
+
+      if(d.use_splice)
+      {
+        d.pipe_rd = pipe_fds[static_cast<std::size_t>(UINT8_C(0))];
+        d.pipe_wr = pipe_fds[static_cast<std::size_t>(UINT8_C(1))];
+
+        // Size the pipe to one chunk. The kernel may round this up
+        // or refuse it beyond its limit, so read back what we got.
+        static_cast<void>(::fcntl(d.pipe_wr, F_SETPIPE_SZ, static_cast<int>(my_chunk_size)));
+
+        const auto pipe_size = ::fcntl(d.pipe_wr, F_GETPIPE_SZ);
+
+        d.pipe_size =
+          (std::min)(my_chunk_size,
+                     (pipe_size > 0) ? static_cast<std::size_t>(pipe_size)
+                                     : static_cast<std::size_t>(UINT16_C(4096)));
+      }
+    }
+
+    auto acquire_buffer(buffer_type& b) -> void
+    {
+      if(!b.data)
+      {
+        if(my_buffer_pool.empty())
+        {
+          b.data = std::make_unique<std::uint8_t[]>(my_chunk_size);
+        }
+        else
+        {
+          b.data = std::move(my_buffer_pool.back());
+
+          my_buffer_pool.pop_back();
+        }
+      }
+    }
+
+    auto release_buffer(buffer_type& b) -> void
+    {
+      if(b.data)
+      {
+        my_buffer_pool.push_back(std::move(b.data));
+      }
+
+      b.head = static_cast<std::size_t>(UINT8_C(0));
+      b.tail = static_cast<std::size_t>(UINT8_C(0));
+    }
+
+    static auto close_pipe(direction_type& d) -> void
+    {
+      if(d.pipe_rd >= 0) { static_cast<void>(::close(d.pipe_rd)); }
+      if(d.pipe_wr >= 0) { static_cast<void>(::close(d.pipe_wr)); }
+
+      d.pipe_rd = -1;
+      d.pipe_wr = -1;
+    }
+
+    // Switch a direction from splicing to pooled buffering, carrying
+    // over whatever already sits in the pipe.
+    auto fall_back_to_buffer(direction_type& d) -> void
+    {
+      if(d.in_pipe != static_cast<std::size_t>(UINT8_C(0)))
+      {
+        acquire_buffer(d.buf);
+
+        while(d.buf.tail < d.in_pipe)
+        {
+          const auto n = ::read(d.pipe_rd, d.buf.data.get() + d.buf.tail, d.in_pipe - d.buf.tail);
+
+          if(n <= static_cast<::ssize_t>(0)) { break; }
+
+          d.buf.tail += static_cast<std::size_t>(n);
+        }
+
+        d.in_pipe = static_cast<std::size_t>(UINT8_C(0));
+      }
+
+      close_pipe(d);
+
+      d.pipe_full  = false;
+      d.use_splice = false;
+    }
+
+    // The errors by which splice(2) reports that one of the
+    // descriptors does not support it.
+    static auto is_splice_unsupported(const int err) -> bool
+    {
+      return ((err == EINVAL) || (err == ENOSYS) || (err == EOPNOTSUPP));
+    }
+
+    static auto is_transient(const int err) -> bool
+    {
+      return ((err == EAGAIN) || (err == EWOULDBLOCK) || (err == EINTR));
+    }
+
+    // Move bytes from the source into the direction's chunk. A source
+    // that fails to read is treated as ended, so that what has already
+    // been read still reaches the sink. Returns true on any progress.
+    auto fill(direction_type& d) -> bool
+    {
+      auto result_progress = false;
+
+      if((!d.src_eof) && (!d.is_error) && has_room(d))
+      {
+        if(d.use_splice)
+        {
+          const auto n =
+            ::splice(d.src, nullptr, d.pipe_wr, nullptr,
+                     d.pipe_size - d.in_pipe,
+                     static_cast<unsigned>(SPLICE_F_MOVE | SPLICE_F_NONBLOCK));
+
+          if     (n >  static_cast<::ssize_t>(0)) { d.in_pipe += static_cast<std::size_t>(n); result_progress = true; }
+          else if(n == static_cast<::ssize_t>(0)) { d.src_eof = true; result_progress = true; }
+          else if(is_splice_unsupported(errno))   { fall_back_to_buffer(d); result_progress = fill(d); }
+          else if(!is_transient(errno))           { d.src_eof = true; result_progress = true; }
+          else
+          {
+            // Small splices each occupy a whole pipe slot, so the pipe
+            // can fill up well before in_pipe reaches its size. Since
+            // EAGAIN may equally mean that the source is empty, stop
+            // reading only while there is something left to drain.
+            d.pipe_full = (d.in_pipe != static_cast<std::size_t>(UINT8_C(0)));
+          }
+        }
+        else
+        {
+          acquire_buffer(d.buf);
+
+          const auto n = ::read(d.src, d.buf.data.get() + d.buf.tail, my_chunk_size - d.buf.tail);
+
+          if     (n >  static_cast<::ssize_t>(0)) { d.buf.tail += static_cast<std::size_t>(n); result_progress = true; }
+          else if(n == static_cast<::ssize_t>(0)) { d.src_eof = true; result_progress = true; }
+          else if(!is_transient(errno))           { d.src_eof = true; result_progress = true; }
+
+          if(!has_pending(d)) { release_buffer(d.buf); }
+        }
+      }
+
+      return result_progress;
+    }
+
+    // Move bytes from the direction's chunk into the sink.
+    // Returns true if any progress was made.
+    auto drain(direction_type& d) -> bool
+    {
+      auto result_progress = false;
+
+      if(has_pending(d) && (!d.is_error))
+      {
+        if(d.use_splice)
+        {
+          const auto n =
+            ::splice(d.pipe_rd, nullptr, d.dst, nullptr,
+                     d.in_pipe,
+                     static_cast<unsigned>(SPLICE_F_MOVE | SPLICE_F_NONBLOCK));
+
+          if     (n > static_cast<::ssize_t>(0)) { d.in_pipe -= static_cast<std::size_t>(n); d.pipe_full = false; result_progress = true; }
+          else if(is_splice_unsupported(errno))  { fall_back_to_buffer(d); result_progress = drain(d); }
+          else if(!is_transient(errno))          { d.is_error = true; }
+        }
+        else
+        {
+          const auto n = ::write(d.dst, d.buf.data.get() + d.buf.head, d.buf.tail - d.buf.head);
+
+          if     (n > static_cast<::ssize_t>(0)) { d.buf.head += static_cast<std::size_t>(n); result_progress = true; }
+          else if(!is_transient(errno))          { d.is_error = true; }
+
+          if(!has_pending(d)) { release_buffer(d.buf); }
+        }
+      }
+
+      return result_progress;
+    }
+
+    auto pump(direction_type& d) -> void
+    {
+      // Alternate between source and sink while either side makes
+      // progress. Bounded so that one busy link can not starve the
+      // others that share this thread.
+      auto progressed = true;
+
+      for(auto round = static_cast<unsigned>(UINT8_C(0)); (round < static_cast<unsigned>(UINT8_C(4))) && progressed; ++round)
+      {
+        const auto filled  = fill(d);
+        const auto drained = drain(d);
+
+        progressed = (filled || drained);
+      }
+    }
+
+    auto final_drain(direction_type& d) -> void
+    {
+      // Flush as much as the sink takes without blocking.
+      while(drain(d)) { ; }
+    }
+
+    auto update_interest(endpoint_type& ep) -> bool
+    {
+      // Read only while the outgoing chunk has room (backpressure),
+      // and wait for writability only while the incoming one has data.
+      const auto want_in  = ((!ep.out->src_eof) && has_room(*ep.out));
+      const auto want_out = has_pending(*ep.in);
+
+      const auto interest =
+        static_cast<std::uint32_t>
+        (
+            (want_in  ? static_cast<std::uint32_t>(EPOLLIN)  : static_cast<std::uint32_t>(UINT8_C(0)))
+          | (want_out ? static_cast<std::uint32_t>(EPOLLOUT) : static_cast<std::uint32_t>(UINT8_C(0)))
+        );
+
+      auto result_update_is_ok = true;
+
+      if(interest != ep.interest)
+      {
+        ep.interest = interest;
+
+        result_update_is_ok = watch(ep, EPOLL_CTL_MOD);
+      }
+
+      return result_update_is_ok;
+    }
+
+    auto watch(endpoint_type& ep, const int op) -> bool
+    {
+      if(op == EPOLL_CTL_ADD)
+      {
+        ep.interest = static_cast<std::uint32_t>(EPOLLIN);
+      }
+
+      auto ev = ::epoll_event { };
+
+      ev.events   = ep.interest;
+      ev.data.ptr = static_cast<void*>(&ep);
+
+      const auto result_watch_is_ok = (::epoll_ctl(my_epoll_fd, op, ep.fd, &ev) == 0);
+
+      if(op == EPOLL_CTL_ADD)
+      {
+        ep.is_watched = result_watch_is_ok;
+      }
+
+      return result_watch_is_ok;
+    }
+
+    auto unwatch(endpoint_type& ep) -> void
+    {
+      // Only remove registrations made for this link. The descriptor
+      // may well be registered on behalf of another one.
+      if(ep.is_watched)
+      {
+        static_cast<void>(::epoll_ctl(my_epoll_fd, EPOLL_CTL_DEL, ep.fd, nullptr));
+
+        ep.is_watched = false;
+      }
+    }
+
+    auto close_link(link_type& lnk, const bool close_socket) -> void
+    {
+      unwatch(lnk.serial);
+      unwatch(lnk.socket);
+
+      for(auto* d : { &lnk.serial_to_socket, &lnk.socket_to_serial })
+      {
+        close_pipe(*d);
+        release_buffer(d->buf);
+      }
+
+      if(close_socket && (lnk.socket.fd >= 0))
+      {
+        static_cast<void>(::close(lnk.socket.fd));
+      }
+
+      lnk.socket.fd = -1;
+
+      lnk.serial.fd = -1;
+    }
+  };
+
+#endif // SERIAL_GATEWAY_2026_10_19_H
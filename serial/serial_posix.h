@@ -0,0 +1,430 @@
+///////////////////////////////////////////////////////////////////////////////
+//  Copyright Christopher Kormanyos 2026.
+//  Distributed under the Boost Software License,
+//  Version 1.0. (See accompanying file LICENSE_1_0.txt
+//  or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef SERIAL_POSIX_2026_10_19_H
+  #define SERIAL_POSIX_2026_10_19_H
+
+  #include <array>
+  #include <cerrno>
+  #include <chrono>
+  #include <cstddef>
+  #include <cstdint>
+  #include <limits>
+  #include <string>
+  #include <vector>
+
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <sys/ioctl.h>
+  #include <termios.h>
+  #include <unistd.h>
+
+  #include <serial_base.h>
+
+  class serial_posix : public serial_base
+  {
+  public:
+    struct adopt_native_handle_type { };
+
+    explicit serial_posix(const std::uint32_t ch,
+                          const std::uint32_t bd     = static_cast<std::uint32_t>(UINT16_C(9600)),
+                          const std::uint32_t n_send = static_cast<std::uint32_t>(UINT32_C(0x10000)),
+                          const std::uint32_t n_recv = static_cast<std::uint32_t>(UINT32_C(0x10000)))
+      : serial_base(ch, bd, n_send, n_recv)
+    {
+      auto result_to_get = std::uint32_t { };
+
+      const auto result_open_is_ok = open(m_scb, result_to_get);
+
+      static_cast<void>(result_open_is_ok);
+      static_cast<void>(result_to_get);
+    }
+
+    // Adopt an already-opened terminal descriptor, such as the
+    // follower side of a pseudo-terminal pair. The descriptor
+    // is owned (and eventually closed) by this object.
+    serial_posix(adopt_native_handle_type,
+                 const int fd,
+                 const std::uint32_t bd     = static_cast<std::uint32_t>(UINT16_C(9600)),
+                 const std::uint32_t n_send = static_cast<std::uint32_t>(UINT32_C(0x10000)),
+                 const std::uint32_t n_recv = static_cast<std::uint32_t>(UINT32_C(0x10000)))
+      : serial_base((std::numeric_limits<std::uint32_t>::max)(), bd, n_send, n_recv),
+        my_fd(fd)
+    {
+      auto result_to_get = std::uint32_t { };
+
+      if((my_fd >= 0) && do_configure(m_scb, result_to_get))
+      {
+        m_is_open  = true;
+        m_is_error = false;
+      }
+      else
+      {
+        m_is_error = true;
+      }
+    }
+
+    ~serial_posix() override
+    {
+      if(is_open())
+      {
+        static_cast<void>(close());
+      }
+      else if(my_fd >= 0)
+      {
+        static_cast<void>(::close(my_fd));
+      }
+    }
+
+    auto open(const t_scb& scb, std::uint32_t& result_to_get) -> bool override
+    {
+      auto result_open_is_ok = bool { };
+
+      if(m_is_open)
+      {
+        result_open_is_ok = false;
+
+        result_to_get = open_ChannelInUse;
+      }
+      else
+      {
+        if(do_open(scb, result_to_get))
+        {
+          m_is_open  = true;
+          m_is_error = false;
+
+          result_open_is_ok = (result_to_get == static_cast<std::uint32_t>(UINT8_C(0)));
+        }
+        else
+        {
+          m_is_open  = false;
+          m_is_error = true;
+
+          result_open_is_ok = false;
+        }
+      }
+
+      return result_open_is_ok;
+    }
+
+    auto close() -> bool override
+    {
+      auto result_close_is_ok = bool { };
+
+      if(is_open())
+      {
+        // Flush and close port.
+        result_close_is_ok = (::tcflush(my_fd, TCIOFLUSH) == 0);
+
+        result_close_is_ok = ((::close(my_fd) == 0) && result_close_is_ok);
+
+        my_fd = -1;
+
+        m_is_open = false;
+      }
+      else
+      {
+        result_close_is_ok = false;
+      }
+
+      return result_close_is_ok;
+    }
+
+    auto recv(::std::vector<std::uint8_t>& recv_buf) const -> std::uint32_t override
+    {
+      const auto count_ready = recv_ready();
+
+      auto result = std::uint32_t { };
+
+      if(count_ready != static_cast<std::uint32_t>(UINT8_C(0)))
+      {
+        recv_buf = ::std::vector<std::uint8_t> { };
+
+        recv_buf.resize(static_cast<std::size_t>(count_ready));
+
+        const auto bytes_read = ::read(my_fd, static_cast<void*>(recv_buf.data()), recv_buf.size());
+
+        recv_buf.resize((bytes_read > static_cast<::ssize_t>(0)) ? static_cast<std::size_t>(bytes_read)
+                                                                 : static_cast<std::size_t>(UINT8_C(0)));
+
+        result = static_cast<std::uint32_t>(recv_buf.size());
+      }
+      else
+      {
+        result = static_cast<std::uint32_t>(UINT8_C(0));
+      }
+
+      return result;
+    }
+
+    auto send_in_progress() const -> bool override
+    {
+      auto result_send_is_in_progress = bool { };
+
+      if(is_open())
+      {
+        auto count_from_outqueue = int { };
+
+        result_send_is_in_progress =
+          (   (::ioctl(my_fd, TIOCOUTQ, &count_from_outqueue) == 0)
+           && (count_from_outqueue > 0));
+      }
+      else
+      {
+        result_send_is_in_progress = false;
+      }
+
+      return result_send_is_in_progress;
+    }
+
+    auto recv_ready() const -> std::uint32_t override
+    {
+      auto count_from_inqueue = std::uint32_t { };
+
+      if(is_open())
+      {
+        auto count = int { };
+
+        const auto result_ioctl_is_ok = (::ioctl(my_fd, FIONREAD, &count) == 0);
+
+        count_from_inqueue =
+          static_cast<std::uint32_t>
+          (
+            (result_ioctl_is_ok && (count > 0)) ? static_cast<std::uint32_t>(count)
+                                                : static_cast<std::uint32_t>(UINT8_C(0))
+          );
+      }
+      else
+      {
+        count_from_inqueue = static_cast<std::uint32_t>(UINT8_C(0));
+      }
+
+      return count_from_inqueue;
+    }
+
+    // The non-blocking descriptor of the open port, or -1.
+    // This is used by the serial gateway to move data without
+    // passing through the vector-based send/recv interface.
+    [[nodiscard]] auto native_handle() const -> int { return my_fd; }
+
+  private:
+    int my_fd { -1 };
+
+    auto ms_for_bytes(std::uint32_t count) const -> int
+    {
+      // Ten bit-times per byte (8N1), expressed in milliseconds.
+      return
+        static_cast<int>
+        (
+          static_cast<std::uintmax_t>
+          (
+              static_cast<std::uintmax_t>
+              (
+                  static_cast<std::uintmax_t>(count)
+                * static_cast<std::uintmax_t>(UINT16_C(10000))
+              )
+            / static_cast<std::uintmax_t>(m_scb.baud)
+          )
+        );
+    }
+
+    static auto baud_to_speed(const std::uint32_t bd, std::uint32_t& bd_actual) -> ::speed_t
+    {
+      using local_baud_pair_type = struct { std::uint32_t baud; ::speed_t speed; };
+
+      constexpr auto baud_table =
+        ::std::array<local_baud_pair_type, static_cast<std::size_t>(UINT8_C(12))>
+        {{
+          {    UINT32_C(1200), B1200   }, {    UINT32_C(2400), B2400   }, {    UINT32_C(4800), B4800   },
+          {    UINT32_C(9600), B9600   }, {   UINT32_C(19200), B19200  }, {   UINT32_C(38400), B38400  },
+          {   UINT32_C(57600), B57600  }, {  UINT32_C(115200), B115200 }, {  UINT32_C(230400), B230400 },
+          {  UINT32_C(460800), B460800 }, {  UINT32_C(921600), B921600 }, { UINT32_C(1000000), B1000000 }
+        }};
+
+      // Select the fastest standard rate that does not exceed the requested one.
+      auto selected = baud_table.front();
+
+      for(const auto& entry : baud_table)
+      {
+        if(entry.baud <= bd)
+        {
+          selected = entry;
+        }
+      }
+
+      bd_actual = selected.baud;
+
+      return selected.speed;
+    }
+
+    auto do_open(const t_scb& scb, std::uint32_t& result) -> bool
+    {
+      result = static_cast<std::uint32_t>(UINT8_C(0));
+
+      // Create name of port: "/dev/ttySn"
+      const auto str_channel = ::std::string("/dev/ttyS") + ::std::to_string(scb.channel);
+
+      my_fd = ::open(str_channel.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+
+      if(my_fd < 0)
+      {
+        switch(errno)
+        {
+          case ENOENT:
+          case ENXIO:
+            result |= static_cast<std::uint32_t>(open_BadChannelNumber);
+            break;
+
+          case EBUSY:
+            result |= static_cast<std::uint32_t>(open_ChannelInUse);
+            break;
+
+          case ENOMEM:
+            result |= static_cast<std::uint32_t>(open_NotEnoughMemory);
+            break;
+
+          default:
+            result |= static_cast<std::uint32_t>(open_ChannelNotAvailable);
+            break;
+        }
+
+        return false;
+      }
+
+      return do_configure(scb, result);
+    }
+
+    auto do_configure(const t_scb& scb, std::uint32_t& result) -> bool
+    {
+      // Ensure that the descriptor is non-blocking, also when adopted.
+      const auto fd_flags = ::fcntl(my_fd, F_GETFL);
+
+      if((fd_flags < 0) || (::fcntl(my_fd, F_SETFL, fd_flags | O_NONBLOCK) < 0))
+      {
+        result |= static_cast<std::uint32_t>(open_ChannelNotAvailable);
+
+        return false;
+      }
+
+      // Setup serial device: raw 8N1, no flow control.
+      auto tio = termios { };
+
+      if(::tcgetattr(my_fd, &tio) != 0)
+      {
+        result |= static_cast<std::uint32_t>(open_InvalidParams);
+
+        return false;
+      }
+
+      ::cfmakeraw(&tio);
+
+      tio.c_cflag |=  static_cast<::tcflag_t>(CLOCAL | CREAD);
+      tio.c_cflag &= ~static_cast<::tcflag_t>(CSTOPB | CRTSCTS);
+      tio.c_iflag &= ~static_cast<::tcflag_t>(IXON | IXOFF | IXANY);
+
+      // With VMIN=0 an empty non-blocking read would return 0 (looking
+      // like end-of-file) instead of failing with EAGAIN.
+      tio.c_cc[VMIN]  = static_cast<::cc_t>(UINT8_C(1));
+      tio.c_cc[VTIME] = static_cast<::cc_t>(UINT8_C(0));
+
+      auto baud_actual = std::uint32_t { };
+
+      const auto speed = baud_to_speed(scb.baud, baud_actual);
+
+      static_cast<void>(::cfsetispeed(&tio, speed));
+      static_cast<void>(::cfsetospeed(&tio, speed));
+
+      if(::tcsetattr(my_fd, TCSANOW, &tio) != 0)
+      {
+        result |= static_cast<std::uint32_t>(open_InvalidParams);
+
+        return false;
+      }
+
+      // Set the serial control block.
+      m_scb = scb;
+
+      if(baud_actual != scb.baud)
+      {
+        m_scb.baud = baud_actual;
+
+        result |= static_cast<std::uint32_t>(open_BaudAdjusted);
+      }
+
+      return true;
+    }
+
+    auto do_send(const ::std::vector<std::uint8_t>& send_buf) -> bool override
+    {
+      auto result_send_is_ok = bool { };
+
+      if(is_open())
+      {
+        if(send_buf.size() == static_cast<std::size_t>(UINT8_C(0)))
+        {
+          result_send_is_ok = true;
+        }
+        else
+        {
+          if(send_in_progress() || (!m_is_open) || m_is_error)
+          {
+            result_send_is_ok = false;
+          }
+          else
+          {
+            // Send the data and return when all of it has been handed
+            // to the driver. Writes that would block are resumed when
+            // the port becomes writable, subject to a timeout.
+
+            using local_clock_type = ::std::chrono::steady_clock;
+
+            const auto timeout =
+                local_clock_type::now()
+              + ::std::chrono::milliseconds(ms_for_bytes(static_cast<std::uint32_t>(send_buf.size())))
+              + ::std::chrono::milliseconds(static_cast<int>(INT16_C(1000)));
+
+            auto number = static_cast<std::size_t>(UINT8_C(0));
+
+            result_send_is_ok = true;
+
+            while((number < send_buf.size()) && result_send_is_ok)
+            {
+              const auto bytes_written =
+                ::write(my_fd,
+                        static_cast<const void*>(send_buf.data() + number),
+                        send_buf.size() - number);
+
+              if(bytes_written > static_cast<::ssize_t>(0))
+              {
+                number += static_cast<std::size_t>(bytes_written);
+              }
+              else if((bytes_written < static_cast<::ssize_t>(0)) && ((errno == EAGAIN) || (errno == EINTR)))
+              {
+                auto pfd = pollfd { my_fd, static_cast<short>(POLLOUT), static_cast<short>(0) };
+
+                static_cast<void>(::poll(&pfd, static_cast<::nfds_t>(UINT8_C(1)), static_cast<int>(INT8_C(10))));
+
+                result_send_is_ok = (local_clock_type::now() <= timeout);
+              }
+              else
+              {
+                result_send_is_ok = false;
+              }
+            }
+          }
+        }
+      }
+      else
+      {
+        result_send_is_ok = false;
+      }
+
+      return result_send_is_ok;
+    }
+  };
+
+#endif // SERIAL_POSIX_2026_10_19_H